@@ -1,5 +1,10 @@
 // Compile with SFML (graphics, window, system, audio):
 // g++ TicTacToe.cpp -o tic_tac_toe -lsfml-graphics -lsfml-window -lsfml-system -lsfml-audio
+//
+// Benchmarking (see README):
+//   ./tic_tac_toe --record session.txt                 play normally, log input with a fixed timestep
+//   ./tic_tac_toe --replay session.txt --offscreen     replay into a RenderTexture as fast as possible
+//   ./tic_tac_toe --replay session.txt --timings t.csv also dump per-frame CPU timings as CSV
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
@@ -10,7 +15,12 @@
 #include <ctime>
 #include <climits>
 #include <cmath>
+#include <cstdio>
+#include <cctype>
 #include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
 using namespace std;
 
 // ---------- Helper Functions ----------
@@ -157,10 +167,9 @@ struct ImageButton {
     bool contains(sf::Vector2i m) const { return bounds.contains((float)m.x, (float)m.y); }
     void updateHover(sf::Vector2i m){ sprite.setColor(sf::Color(255,255,255, contains(m) ? (sf::Uint8)hoverAlpha : (sf::Uint8)normalAlpha)); }
 
-    // draw with optional pulse effect when hovered
-    void drawWithPulse(sf::RenderWindow& w, float timeSeconds, bool pulseWhenHovered=true){
+    // draw with optional pulse effect when hovered (ms is the current mouse position in window coords)
+    void drawWithPulse(sf::RenderTarget& w, sf::Vector2i ms, float timeSeconds, bool pulseWhenHovered=true){
         // compute hover state
-        sf::Vector2i ms = sf::Mouse::getPosition(w);
         bool hovered = contains(ms);
         // store original scale to restore later
         sf::Vector2f origScale = sprite.getScale();
@@ -204,14 +213,174 @@ struct ImageButton {
     }
 };
 
+// ---------- Input Record / Replay ----------
+// Text log: a "seed <n>" header, one "<frame> <ms> <kind> <x> <y>" line per input event and an
+// "end <frames>" footer. Replay is keyed on the frame number (the game runs with a fixed timestep
+// while recording or replaying), the millisecond timestamp is kept for reference only.
+// kind: M = mouse moved, P = left button pressed, L = mouse left the window, C = window closed
+struct InputEvent { long frame; long ms; char kind; int x, y; };
+
+class InputRecorder {
+public:
+    bool open(const string& path, unsigned seed){
+        out.open(path);
+        if(!out) return false;
+        out << "seed " << seed << "\n";
+        return true;
+    }
+    // log kind for `e`, or 0 if the event is not part of the log format
+    static char kindOf(const sf::Event& e){
+        if(e.type==sf::Event::MouseMoved) return 'M';
+        if(e.type==sf::Event::MouseButtonPressed && e.mouseButton.button==sf::Mouse::Left) return 'P';
+        if(e.type==sf::Event::MouseLeft) return 'L';
+        if(e.type==sf::Event::Closed) return 'C';
+        return 0;
+    }
+    void write(long frame, long ms, const sf::Event& e){
+        char kind = kindOf(e);
+        if(!out || !kind) return;
+        int x = 0, y = 0;
+        if(kind=='M'){ x=e.mouseMove.x; y=e.mouseMove.y; }
+        else if(kind=='P'){ x=e.mouseButton.x; y=e.mouseButton.y; }
+        out << frame << ' ' << ms << ' ' << kind << ' ' << x << ' ' << y << "\n";
+    }
+    void finish(long frames){ if(out) out << "end " << frames << "\n"; }
+private:
+    ofstream out;
+};
+
+class InputReplay {
+public:
+    unsigned seed = 0;
+    long lastFrame = 0; // number of frames the recording ran for
+
+    bool load(const string& path){
+        ifstream in(path);
+        if(!in) return false;
+        string tok;
+        bool ended = false;
+        while(in >> tok){
+            if(tok=="seed"){ if(!(in >> seed)) return false; }
+            else if(tok=="end"){ if(!(in >> lastFrame)) return false; ended = true; }
+            else {
+                InputEvent ev{};
+                istringstream frameTok(tok);
+                if(!(frameTok >> ev.frame) || !frameTok.eof()) return false;
+                if(!(in >> ev.ms >> ev.kind >> ev.x >> ev.y)) return false;
+                if(string("MPLC").find(ev.kind) == string::npos) return false;
+                // eventsFor walks the log forwards, so frames must never go backwards
+                if(ev.frame < 0 || (!events.empty() && ev.frame < events.back().frame)) return false;
+                events.push_back(ev);
+            }
+        }
+        if(!ended && !events.empty()) lastFrame = events.back().frame + 1;
+        return true;
+    }
+    // append every event recorded for `frame` to `out` (frames must be requested in increasing order)
+    void eventsFor(long frame, vector<sf::Event>& out){
+        while(cursor < events.size() && events[cursor].frame <= frame){
+            const InputEvent& ev = events[cursor++];
+            sf::Event e{};
+            if(ev.kind=='M'){ e.type=sf::Event::MouseMoved; e.mouseMove.x=ev.x; e.mouseMove.y=ev.y; }
+            else if(ev.kind=='P'){ e.type=sf::Event::MouseButtonPressed; e.mouseButton.button=sf::Mouse::Left; e.mouseButton.x=ev.x; e.mouseButton.y=ev.y; }
+            else if(ev.kind=='L') e.type=sf::Event::MouseLeft;
+            else e.type=sf::Event::Closed; // load() only accepts M, P, L and C
+            out.push_back(e);
+        }
+    }
+    bool finished(long frame) const { return frame >= lastFrame; }
+private:
+    vector<InputEvent> events;
+    size_t cursor = 0;
+};
+
+// ---------- Frame Timings ----------
+// per-frame CPU time (update + draw calls, excluding display/vsync), grouped by what was on screen
+struct FrameTimings {
+    struct Sample { long frame; const char* phase; double us; };
+    vector<Sample> samples;
+
+    void add(long frame, const char* phase, double us){ samples.push_back({frame, phase, us}); }
+
+    bool writeCsv(const string& path) const {
+        ofstream out(path);
+        if(!out) return false;
+        out << "frame,phase,cpu_us\n";
+        for(auto& s : samples) out << s.frame << ',' << s.phase << ',' << s.us << "\n";
+        return true;
+    }
+
+    void printSummary(ostream& os) const {
+        os << "phase        frames    mean_us     p50_us     p95_us     max_us\n";
+        for(const char* phase : { "menu", "transition", "game", "all" }){
+            vector<double> v;
+            for(auto& s : samples) if(string(phase)=="all" || string(phase)==s.phase) v.push_back(s.us);
+            if(v.empty()) continue;
+            sort(v.begin(), v.end());
+            double sum = 0; for(double x : v) sum += x;
+            auto pct = [&](double p){ return v[min(v.size()-1, (size_t)(p * (v.size()-1) + 0.5))]; };
+            char line[128];
+            snprintf(line, sizeof(line), "%-10s %8zu %10.1f %10.1f %10.1f %10.1f\n",
+                     phase, v.size(), sum / v.size(), pct(0.5), pct(0.95), v.back());
+            os << line;
+        }
+    }
+};
+
 // ---------- Enums ----------
 enum class Difficulty { EASY, MEDIUM, HARD };
 
-int main(){
-    srand((unsigned)time(nullptr));
+int main(int argc, char** argv){
+    // ----- Command line -----
+    string recordPath, replayPath, timingsPath;
+    bool offscreen = false, seedGiven = false;
+    unsigned seed = (unsigned)time(nullptr);
+    const string usage = string("usage: ") + argv[0] + " [--record FILE | --replay FILE [--offscreen]] [--seed N] [--timings FILE]\n";
+    for(int i=1;i<argc;i++){
+        string a = argv[i];
+        if(a=="--record" && i+1<argc) recordPath = argv[++i];
+        else if(a=="--replay" && i+1<argc) replayPath = argv[++i];
+        else if(a=="--timings" && i+1<argc) timingsPath = argv[++i];
+        else if(a=="--seed" && i+1<argc){
+            istringstream seedArg(argv[++i]);
+            if(!isdigit((unsigned char)argv[i][0]) || !(seedArg >> seed) || !seedArg.eof()){ cerr<<usage; return 1; }
+            seedGiven = true;
+        }
+        else if(a=="--offscreen") offscreen = true;
+        else { cerr<<usage; return 1; }
+    }
+    bool recording = !recordPath.empty(), replaying = !replayPath.empty();
+    if(recording && replaying){ cerr<<"--record and --replay are mutually exclusive\n"; return 1; }
+    if(offscreen && !replaying){ cerr<<"--offscreen requires --replay\n"; return 1; }
+
+    InputRecorder recorder;
+    InputReplay replay;
+    if(replaying){
+        if(!replay.load(replayPath)){ cerr<<"failed to read replay "<<replayPath<<"\n"; return 1; }
+        if(seedGiven) cerr<<"ignoring --seed, using the seed stored in "<<replayPath<<"\n";
+        seed = replay.seed;
+    }
+    if(recording && !recorder.open(recordPath, seed)){ cerr<<"failed to open "<<recordPath<<" for writing\n"; return 1; }
+    srand(seed);
+
+    // recording and replaying both step the simulation by a fixed dt so frame N sees the same state
+    const float FIXED_DT = 1.f/60.f;
+    bool fixedStep = recording || replaying;
+    bool collectTimings = replaying || !timingsPath.empty();
+
     const int WIN_W = 960, WIN_H = 720;
-    sf::RenderWindow w(sf::VideoMode(WIN_W, WIN_H), "TicTacToe+", sf::Style::Close);
-    w.setFramerateLimit(60);
+    sf::RenderWindow window;
+    sf::RenderTexture canvas;
+    if(offscreen){
+        if(!canvas.create(WIN_W, WIN_H)){ cerr<<"failed to create offscreen render texture\n"; return 1; }
+    } else {
+        window.create(sf::VideoMode(WIN_W, WIN_H), "TicTacToe+", sf::Style::Close);
+        window.setFramerateLimit(60);
+    }
+    // everything below draws into `w`, which is either the window or the offscreen canvas
+    sf::RenderTarget& w = offscreen ? static_cast<sf::RenderTarget&>(canvas) : window;
+    bool running = true;
+    auto quit = [&](){ running = false; if(window.isOpen()) window.close(); };
 
     //------ Fonts & Titles ----
     sf::Font font;
@@ -272,8 +441,10 @@ int main(){
     if (!winBuf.loadFromFile("assets/win.wav")) cerr<<"missing win.wav\n";
     if (!bgm.openFromFile("assets/bgm.ogg")) cerr<<"missing bgm.ogg\n";
     bgm.setLoop(true); bgm.setVolume(40.f);
-    bgm.play();
+    if(!offscreen) bgm.play();
     sf::Sound click(clickBuf), move(moveBuf), winSnd(winBuf);
+    // an offscreen replay runs unthrottled, keep sound effects out of it and out of the timings
+    auto playSfx = [&](sf::Sound& snd){ if(!offscreen) snd.play(); };
 
     sf::Sprite bgNight(bgTex), bgDay(bgTex2);
     bgNight.setScale((float)WIN_W/bgTex.getSize().x, (float)WIN_H/bgTex.getSize().y);
@@ -340,12 +511,42 @@ int main(){
     float offsetX = 0.f;
     float speed = 30.f;
 
-    while(w.isOpen()){
-        float dt = clk.restart().asSeconds(); pulseTimer += dt; bgTimer += dt; glowTimer += dt;
-        sf::Event e;
-        while(w.pollEvent(e)){
-            if(e.type==sf::Event::Closed) w.close();
-            sf::Vector2i ms = sf::Mouse::getPosition(w);
+    // input is driven by events only so a replay reproduces hover state exactly
+    sf::Vector2i mousePos(-1, -1);
+    long frame = 0;
+    sf::Clock runClock, frameClock;
+    FrameTimings timings;
+    vector<sf::Event> events;
+
+    while(running){
+        float dt = fixedStep ? FIXED_DT : clk.restart().asSeconds();
+        pulseTimer += dt; bgTimer += dt; glowTimer += dt;
+
+        events.clear();
+        sf::Event polled;
+        if(replaying){
+            // a visible replay still services the window, but only honours closing it
+            while(window.isOpen() && window.pollEvent(polled)) if(polled.type==sf::Event::Closed) quit();
+            replay.eventsFor(frame, events);
+        } else {
+            while(window.pollEvent(polled)){
+                // while recording, the game only sees events the log can reproduce on replay
+                if(recording){
+                    if(!InputRecorder::kindOf(polled)) continue;
+                    recorder.write(frame, runClock.getElapsedTime().asMilliseconds(), polled);
+                }
+                events.push_back(polled);
+            }
+        }
+        // time from here on so windowed and offscreen runs measure the same work (update + draw)
+        frameClock.restart();
+
+        for(const sf::Event& e : events){
+            if(e.type==sf::Event::Closed) quit();
+            if(e.type==sf::Event::MouseMoved) mousePos = { e.mouseMove.x, e.mouseMove.y };
+            else if(e.type==sf::Event::MouseButtonPressed) mousePos = { e.mouseButton.x, e.mouseButton.y };
+            else if(e.type==sf::Event::MouseLeft) mousePos = { -1, -1 };
+            sf::Vector2i ms = mousePos;
 
             // update hover state (alpha)
             bStart.updateHover(ms); bExit.updateHover(ms); bPvp.updateHover(ms); bAi.updateHover(ms);
@@ -359,18 +560,18 @@ int main(){
             if (bgTex2.getSize().x>0) bgNight.setScale(scalePulse * (float)WIN_W / bgTex2.getSize().x, scalePulse * (float)WIN_H / bgTex2.getSize().y);
 
             if(e.type==sf::Event::MouseButtonPressed && e.mouseButton.button==sf::Mouse::Left && !transitioning){
-                click.play();
+                playSfx(click);
                 if(state==GState::MAIN_MENU){
                     if(bStart.contains(ms)) startTransition(GState::MODE_SELECT);
-                    else if(bExit.contains(ms)) w.close();
+                    else if(bExit.contains(ms)) quit();
                 } else if(state==GState::MODE_SELECT){
                     if(bRestart.contains(ms)){ startTransition(GState::MAIN_MENU); }
-                    else if(bMenu.contains(ms)){ w.close(); }
+                    else if(bMenu.contains(ms)){ quit(); }
                     else if(bPvp.contains(ms)){ vsAI=false; Board=getBoard(); gameOver=false; isXturn=true; msgStr.clear(); aiThinking=false; aiTimer=0.f; startTransition(GState::PLAYING); }
                     else if(bAi.contains(ms)){ vsAI=true; Board=getBoard(); gameOver=false; isXturn=true; msgStr.clear(); aiThinking=false; aiTimer=0.f; startTransition(GState::DIFFICULTY); }
                 } else if(state==GState::DIFFICULTY){
                     if(bRestart.contains(ms)){ startTransition(GState::MODE_SELECT); }
-                    else if(bMenu.contains(ms)){ w.close(); }
+                    else if(bMenu.contains(ms)){ quit(); }
                     else if(bEasy.contains(ms)){ diff=Difficulty::EASY; startTransition(GState::PLAYING); }
                     else if(bMed.contains(ms)){ diff=Difficulty::MEDIUM; startTransition(GState::PLAYING); }
                     else if(bHard.contains(ms)){ diff=Difficulty::HARD; startTransition(GState::PLAYING); }
@@ -380,22 +581,22 @@ int main(){
                     else if(!gameOver){
                         auto [r,c] = mouseToCell(ms);
                         if(r>=0&&r<3&&c>=0&&c<3&&Board[r][c]=='#'){
-                            move.play();
+                            playSfx(move);
                             if(!vsAI){
                                 char sym = isXturn ? 'X' : 'O';
                                 Board[r][c] = sym;
                                 if(checkWin(Board, sym)){
-                                    msgStr = string(1,sym) + " wins!"; gameOver = true; winSnd.play();
+                                    msgStr = string(1,sym) + " wins!"; gameOver = true; playSfx(winSnd);
                                 }
-                                else if(checkDraw(Board)){ msgStr = "Draw!"; gameOver = true; winSnd.play(); }
+                                else if(checkDraw(Board)){ msgStr = "Draw!"; gameOver = true; playSfx(winSnd); }
                                 else isXturn = !isXturn;
                             } else {
                                 // Player is X in PvE
                                 Board[r][c] = 'X';
                                 if(checkWin(Board,'X')){
-                                    msgStr = "You win!"; gameOver = true; winSnd.play();
+                                    msgStr = "You win!"; gameOver = true; playSfx(winSnd);
                                 } else if(checkDraw(Board)){
-                                    msgStr = "Draw!"; gameOver = true; winSnd.play();
+                                    msgStr = "Draw!"; gameOver = true; playSfx(winSnd);
                                 } else {
                                     // start AI thinking (1s delay)
                                     aiThinking = true;
@@ -422,16 +623,16 @@ int main(){
             // small visual delay before AI plays  (1.0f seconds)
             if(aiTimer >= 1.0f){
                 aiMove(Board, diff);
-                move.play();
+                playSfx(move);
                 // Evaluate result
                 if(checkWin(Board,'O')){
                     msgStr = "AI wins!";
                     gameOver = true;
-                    winSnd.play();
+                    playSfx(winSnd);
                 } else if(checkDraw(Board)){
                     msgStr = "Draw!";
                     gameOver = true;
-                    winSnd.play();
+                    playSfx(winSnd);
                 }
                 // AI finished
                 aiThinking = false;
@@ -485,8 +686,8 @@ int main(){
             shadow.move(4.f, 6.f);
             w.draw(shadow);
             w.draw(title);
-            bStart.drawWithPulse(w, pulseTimer, false);
-            bExit.drawWithPulse(w, pulseTimer, false);
+            bStart.drawWithPulse(w, mousePos, pulseTimer, false);
+            bExit.drawWithPulse(w, mousePos, pulseTimer, false);
         }
         else if(state==GState::MODE_SELECT){
             modeText.setPosition((WIN_W - modeText.getGlobalBounds().width) / 2.f, 110.f);
@@ -501,13 +702,13 @@ int main(){
             float startY = 220.f;
             bPvp.setPosition({btnX, startY});
             bAi.setPosition({btnX, startY + 120.f});
-            bPvp.drawWithPulse(w, pulseTimer, false);
-            bAi.drawWithPulse(w, pulseTimer, false);
+            bPvp.drawWithPulse(w, mousePos, pulseTimer, false);
+            bAi.drawWithPulse(w, mousePos, pulseTimer, false);
 
             bRestart.setPosition({140.f, WIN_H - 96.f});
             bMenu.setPosition({WIN_W - 360.f, WIN_H - 96.f});
-            bRestart.drawWithPulse(w, pulseTimer, true);
-            bMenu.drawWithPulse(w, pulseTimer, true);
+            bRestart.drawWithPulse(w, mousePos, pulseTimer, true);
+            bMenu.drawWithPulse(w, mousePos, pulseTimer, true);
         }
         else if(state==GState::DIFFICULTY){
             difficultyText.setPosition((WIN_W - difficultyText.getGlobalBounds().width) / 2.f, 110.f);
@@ -524,9 +725,9 @@ int main(){
             bMed.setPosition({ startX + bEasy.bounds.width + 40.f, y });
             bHard.setPosition({ startX + bEasy.bounds.width + 40.f + bMed.bounds.width + 40.f, y });
 
-            bEasy.drawWithPulse(w, pulseTimer, false);
-            bMed.drawWithPulse(w, pulseTimer, false);
-            bHard.drawWithPulse(w, pulseTimer, false);
+            bEasy.drawWithPulse(w, mousePos, pulseTimer, false);
+            bMed.drawWithPulse(w, mousePos, pulseTimer, false);
+            bHard.drawWithPulse(w, mousePos, pulseTimer, false);
 
             easyLabel.setPosition(bEasy.bounds.left + (bEasy.bounds.width - easyLabel.getGlobalBounds().width)/2.f, bEasy.bounds.top - 36.f);
             medLabel.setPosition(bMed.bounds.left + (bMed.bounds.width - medLabel.getGlobalBounds().width)/2.f, bMed.bounds.top - 36.f);
@@ -538,8 +739,8 @@ int main(){
 
             bRestart.setPosition({140.f, WIN_H - 96.f});
             bMenu.setPosition({WIN_W - 360.f, WIN_H - 96.f});
-            bRestart.drawWithPulse(w, pulseTimer, true);
-            bMenu.drawWithPulse(w, pulseTimer, true);
+            bRestart.drawWithPulse(w, mousePos, pulseTimer, true);
+            bMenu.drawWithPulse(w, mousePos, pulseTimer, true);
         }
         else if(state==GState::PLAYING || state==GState::GAME_OVER){
             sf::Sprite boardSprite;
@@ -639,12 +840,30 @@ int main(){
 
             bRestart.setPosition({140.f, WIN_H - 96.f});
             bMenu.setPosition({WIN_W - 360.f, WIN_H - 96.f});
-            bRestart.drawWithPulse(w, pulseTimer, true);
-            bMenu.drawWithPulse(w, pulseTimer, true);
+            bRestart.drawWithPulse(w, mousePos, pulseTimer, true);
+            bMenu.drawWithPulse(w, mousePos, pulseTimer, true);
         }
 
         if(transitioning) w.draw(fade);
-        w.display();
+
+        if(collectTimings){
+            const char* timingPhase = transitioning ? "transition"
+                                    : (state==GState::PLAYING || state==GState::GAME_OVER) ? "game" : "menu";
+            timings.add(frame, timingPhase, frameClock.getElapsedTime().asMicroseconds());
+        }
+
+        if(offscreen) canvas.display();
+        else window.display();
+
+        ++frame;
+        if(replaying && replay.finished(frame)) quit();
+    }
+
+    if(recording) recorder.finish(frame);
+    if(collectTimings){
+        if(!timingsPath.empty() && !timings.writeCsv(timingsPath)) cerr<<"failed to write "<<timingsPath<<"\n";
+        cout << frame << " frames" << (replaying ? " replayed from " + replayPath : string()) << "\n";
+        timings.printSummary(cout);
     }
 
     return 0;